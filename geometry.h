@@ -90,6 +90,9 @@ inline vec3 cross(const vec3 &v1, const vec3 &v2) {
     return {v1.y*v2.z - v1.z*v2.y, v1.z*v2.x - v1.x*v2.z, v1.x*v2.y - v1.y*v2.x};
 }
 
+template<int rows, int cols> struct mat;
+template<int n> double det(const mat<n,n>& src);
+
 template<int rows, int cols> struct mat {
     vec<cols> data[rows];
     vec<cols>& operator[](const int i)       { assert(i>=0 && i<rows); return data[i]; }
@@ -101,7 +104,7 @@ template<int rows, int cols> struct mat {
     }
 
     double cofactor(const int row, const int col) const {
-        assert(row==col && row>=2); // rules for cofactor
+        assert(rows==cols && rows>=2); // rules for cofactor
         mat<rows-1,cols-1> sub;
         for (int i=0, subi=0; i<rows; i++) {
             if (i == row) continue;
@@ -170,11 +173,11 @@ template<int rows, int cols> mat<rows,cols> operator*(const mat<rows,cols>& lhs,
     return result;
 }
 
-template<int rows, int cols> mat<rows,cols> operator/(const double lhs, const mat<rows,cols>& rhs) {
+template<int rows, int cols> mat<rows,cols> operator/(const mat<rows,cols>& lhs, const double rhs) {
     mat<rows,cols> result;
     for (int i=0; i<rows; i++)
         for (int j=0; j<cols; j++)
-            result[i][j] = rhs[i][j] / lhs;
+            result[i][j] = lhs[i][j] / rhs;
     return result;
 }
 
@@ -195,13 +198,15 @@ template<int rows, int cols> mat<rows,cols> operator-(const mat<rows,cols>& lhs,
 }
 
 template<int n> double det(const mat<n,n>& src) { //recursive determinant calculation
-    if (n == 1){
+    if constexpr (n == 1){
         return src[0][0];
     }
-    double ret = 0;
-    for (int i=0; i<n; i++){
-        ret += src[0][i] * src.cofactor(0,i)
+    else {
+        double ret = 0;
+        for (int i=0; i<n; i++){
+            ret += src[0][i] * src.cofactor(0,i);
+        }
+        return ret;
     }
-    return ret;
 }
 
@@ -1,5 +1,7 @@
 #include <limits>
 #include <algorithm>
+#include <chrono>
+#include <string>
 #include "geometry.h"
 #include "model.h"
 #include "tgaimage.h"
@@ -44,9 +46,204 @@ void rasterize(const vec4 clip[3], std::vector<double> &zbuffer, TGAImage &frame
     }
 }
 
+struct Segment {    // screen space edge, set up once for the DDA
+    int x, y;       // first pixel
+    int n;          // number of steps along the major axis
+    int sign;       // direction along the major axis
+    int step;       // minor axis increment per step, 16.16 fixed point
+    bool steep;     // y is the major axis
+    int ymin, ymax; // rows covered by the edge
+    double z, dz;   // ndc depth of the first pixel and its increment per step
+};
+
+// Liang-Barsky step: clips the parameter range [t0,t1] of a segment to the half-space f>=0,
+// fa and fb are the plane equation evaluated at the segment ends
+bool clip_plane(const double fa, const double fb, double &t0, double &t1) {
+    if (fa<0 && fb<0) return false;
+    if (fa<0) t0 = std::max(t0, fa/(fa-fb));
+    if (fb<0) t1 = std::min(t1, fa/(fa-fb));
+    return t0<=t1;
+}
+
+// clips the edge {a,b} to the view volume in homogeneous coordinates and projects what is left to the screen
+bool project_edge(const vec4 a, const vec4 b, const int width, const int height, Segment &s) {
+    constexpr double wmin = 1e-3; // keep w away from zero, the perspective division is undefined behind the camera
+    double t0 = 0, t1 = 1;
+    if (!clip_plane(a.w-wmin, b.w-wmin, t0, t1)) return false;
+    if (!clip_plane(a.w-a.x,  b.w-b.x,  t0, t1)) return false; // x <=  w
+    if (!clip_plane(a.w+a.x,  b.w+b.x,  t0, t1)) return false; // x >= -w
+    if (!clip_plane(a.w-a.y,  b.w-b.y,  t0, t1)) return false; // y <=  w
+    if (!clip_plane(a.w+a.y,  b.w+b.y,  t0, t1)) return false; // y >= -w
+    vec4 ndc[2] = { a + (b-a)*t0, a + (b-a)*t1 };
+    int px[2], py[2];
+    for (int d : {0,1}) {
+        ndc[d] = ndc[d]/ndc[d].w;
+        vec4 screen = Viewport*ndc[d];
+        px[d] = std::clamp(static_cast<int>(screen.x), 0, width-1);  // the clipped edge may touch the far border of the viewport
+        py[d] = std::clamp(static_cast<int>(screen.y), 0, height-1);
+    }
+    const int dx = px[1]-px[0], dy = py[1]-py[0];
+    s.x = px[0];
+    s.y = py[0];
+    s.steep = std::abs(dy) > std::abs(dx);
+    s.n     = std::max(std::abs(dx), std::abs(dy));
+    s.sign  = (s.steep ? dy : dx) < 0 ? -1 : 1;
+    s.step  = (s.steep ? dx : dy) * 65536 / std::max(s.n, 1);
+    s.ymin  = std::min(py[0], py[1]);
+    s.ymax  = std::max(py[0], py[1]);
+    s.z     = ndc[0].z;
+    s.dz    = s.n ? (ndc[1].z-ndc[0].z)/s.n : 0;
+    return true;
+}
+
+int floor_div(const int a, const int b) { // rounds towards -infinity, b > 0
+    return a/b - (a%b != 0 && a<0);
+}
+
+// integer DDA: steps one pixel along the major axis and keeps the minor axis in 16.16 fixed point,
+// only the rows ylo <= y < yhi are written so that several threads can share a framebuffer
+void line(const Segment &s, const int ylo, const int yhi, TGAImage &framebuffer, const std::vector<double> *zbuffer, const TGAColor color) {
+    constexpr double bias = 1e-2; // lets an edge win the depth test against the triangles it borders
+    const int w = framebuffer.width(), bpp = framebuffer.bytespp();
+    std::uint8_t *pixels = framebuffer.buffer();
+    const int acc0 = ((s.steep ? s.x : s.y) << 16) + (1 << 15); // +0.5 rounds the minor coordinate
+    int first = 0, last = s.n; // steps that land inside the band
+    if (s.ymin<ylo || s.ymax>=yhi) {
+        if (s.steep) {         // y is the major axis
+            first = std::max(first, s.sign>0 ? ylo-s.y : s.y-(yhi-1));
+            last  = std::min(last,  s.sign>0 ? yhi-1-s.y : s.y-ylo);
+        }
+        else if (s.step) {     // y is the minor axis, acc0 + i*step crosses the band borders monotonically
+            int below = floor_div(acc0 - (ylo << 16), std::abs(s.step)), above = floor_div(acc0 - (yhi << 16), std::abs(s.step));
+            first = std::max(first, s.step>0 ? -below : above+1);
+            last  = std::min(last,  s.step>0 ? -above-1 : below);
+        }
+    }
+    int acc = acc0 + first*s.step;
+    int major = (s.steep ? s.y : s.x) + first*s.sign;
+    double z = s.z + first*s.dz;
+    for (int i=first; i<=last; i++, acc+=s.step, major+=s.sign, z+=s.dz) {
+        int offset = s.steep ? (acc >> 16) + major*w : major + (acc >> 16)*w;
+        if (zbuffer && z + bias < (*zbuffer)[offset]) continue; // hidden behind a triangle
+        for (int c=0; c<bpp; c++) pixels[offset*bpp+c] = color.bgra[c];
+    }
+}
+
+// draws all segments, the screen is split into bands of rows and every band is drawn by a single thread
+void wireframe(const std::vector<Segment> &segments, TGAImage &framebuffer, const std::vector<double> *zbuffer, const TGAColor color) {
+    constexpr int band = 32; // rows per band
+    const int nbands = (framebuffer.height()+band-1)/band;
+    std::vector<std::vector<int>> bins(nbands); // indices of the segments crossing each band, sorted once so no band scans the whole list
+    for (int i=0; i<static_cast<int>(segments.size()); i++)
+        for (int b=segments[i].ymin/band; b<=segments[i].ymax/band; b++)
+            bins[b].push_back(i);
+#pragma omp parallel for schedule(dynamic)
+    for (int b=0; b<nbands; b++) {
+        int ylo = b*band, yhi = std::min(ylo+band, framebuffer.height());
+        for (int i : bins[b])
+            line(segments[i], ylo, yhi, framebuffer, zbuffer, color);
+    }
+}
+
+// transforms every vertex once and projects the unique edges of the model
+std::vector<Segment> project_edges(const Model &model, const int width, const int height) {
+    const mat<4,4> M = Perspective * ModelView;
+    std::vector<vec4> clip(model.nverts());
+    for (int i=0; i<model.nverts(); i++) {
+        vec3 v = model.vert(i);
+        clip[i] = M * vec4{v.x, v.y, v.z, 1.};
+    }
+    std::vector<Segment> segments;
+    segments.reserve(model.nedges());
+    for (int i=0; i<model.nedges(); i++) {
+        Segment s;
+        if (project_edge(clip[model.edge(i, 0)], clip[model.edge(i, 1)], width, height, s))
+            segments.push_back(s);
+    }
+    return segments;
+}
+
+// line drawing from notes/, kept as the reference for the benchmark: float stepping, round() and TGAImage::set() per pixel
+void line_reference(int ax, int ay, int bx, int by, TGAImage &framebuffer, TGAColor color) {
+    bool steep = false;
+    if (std::abs(ax - bx) < std::abs(ay - by)) {
+        std::swap(ax, ay);
+        std::swap(bx, by);
+        steep = true;
+    }
+    if (ax > bx) {
+        std::swap(ax, bx);
+        std::swap(ay, by);
+    }
+    for (float x = ax; x <= bx; x += 1) {
+        float t = (float)((x - ax) / (bx - ax));
+        int y = round(ay * (1.0 - t) + by * t);
+        if (steep) {
+            framebuffer.set(y, x, color);
+        }
+        else {
+            framebuffer.set(x, y, color);
+        }
+    }
+}
+
+// draws the wireframe of the model three ways and reports the throughput of each:
+// the reference line() on every side of every face, the DDA kernel on the same lines, and the DDA kernel on the unique edges
+void benchmark(const Model &model, const int width, const int height, const TGAColor color) {
+    constexpr int runs = 20;
+    TGAImage framebuffer(width, height, TGAImage::RGB);
+    using clock = std::chrono::steady_clock;
+
+    auto start = clock::now();
+    for (int r=0; r<runs; r++) {
+        for (int i=0; i<model.nfaces(); i++) { // every side of every triangle, transformed per face
+            vec2 screen[3];
+            for (int d : {0,1,2}) {
+                vec3 v = model.vert(i, d);
+                vec4 ndc = Perspective * ModelView * vec4{v.x, v.y, v.z, 1.};
+                ndc = Viewport * (ndc/ndc.w);
+                screen[d] = {ndc.x, ndc.y};
+            }
+            for (int d : {0,1,2})
+                line_reference(screen[d].x, screen[d].y, screen[(d+1)%3].x, screen[(d+1)%3].y, framebuffer, color);
+        }
+    }
+    double reference = std::chrono::duration<double>(clock::now()-start).count();
+
+    start = clock::now();
+    for (int r=0; r<runs; r++) {
+        std::vector<Segment> segments;
+        segments.reserve(model.nfaces()*3);
+        for (int i=0; i<model.nfaces(); i++) { // same lines as the reference, transformed per face
+            vec4 clip[3];
+            for (int d : {0,1,2}) {
+                vec3 v = model.vert(i, d);
+                clip[d] = Perspective * ModelView * vec4{v.x, v.y, v.z, 1.};
+            }
+            Segment s;
+            for (int d : {0,1,2})
+                if (project_edge(clip[d], clip[(d+1)%3], width, height, s))
+                    segments.push_back(s);
+        }
+        wireframe(segments, framebuffer, nullptr, color);
+    }
+    double kernel = std::chrono::duration<double>(clock::now()-start).count();
+
+    start = clock::now();
+    for (int r=0; r<runs; r++)
+        wireframe(project_edges(model, width, height), framebuffer, nullptr, color);
+    double batched = std::chrono::duration<double>(clock::now()-start).count();
+
+    std::cout << "reference, per face:    " << 3.*model.nfaces()*runs/reference << " lines/s, " << reference*1e3/runs << " ms per wireframe" << std::endl;
+    std::cout << "kernel, per face:       " << 3.*model.nfaces()*runs/kernel    << " lines/s, " << kernel*1e3/runs    << " ms per wireframe" << std::endl;
+    std::cout << "kernel, unique edges:   " << 1.*model.nedges()*runs/batched   << " lines/s, " << batched*1e3/runs   << " ms per wireframe" << std::endl;
+}
+
 int main(int argc, char** argv) {
-    if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " obj/model.obj" << std::endl;
+    std::string mode = argc > 1 ? argv[1] : "";
+    int first = (mode == "-w" || mode == "-o" || mode == "-b") ? 2 : 1; // -w wireframe, -o triangles with a wireframe overlay, -b benchmark
+    if (argc <= first) {
+        std::cerr << "Usage: " << argv[0] << " [-w|-o|-b] obj/model.obj" << std::endl;
         return 1;
     }
 
@@ -63,8 +260,18 @@ int main(int argc, char** argv) {
     TGAImage framebuffer(width, height, TGAImage::RGB);
     std::vector<double> zbuffer(width*height, -std::numeric_limits<double>::max());
 
-    for (int m=1; m<argc; m++) { // iterate through all input objects
+    constexpr TGAColor white = { 255, 255, 255, 255 }; // attention, BGRA order
+
+    for (int m=first; m<argc; m++) { // iterate through all input objects
         Model model(argv[m]);
+        if (mode == "-b") {
+            benchmark(model, width, height, white);
+            continue;
+        }
+        if (mode == "-w") {
+            wireframe(project_edges(model, width, height), framebuffer, nullptr, white);
+            continue;
+        }
         for (int i=0; i<model.nfaces(); i++) { // iterate through all triangles
             vec4 clip[3];
             for (int d : {0,1,2}) {            // assemble the primitive
@@ -75,7 +282,10 @@ int main(int argc, char** argv) {
             for (int c=0; c<3; c++) rnd[c] = std::rand()%255;
             rasterize(clip, zbuffer, framebuffer, rnd); // rasterize the primitive
         }
+        if (mode == "-o")
+            wireframe(project_edges(model, width, height), framebuffer, &zbuffer, white); // depth tested against the triangles
     }
+    if (mode == "-b") return 0; // nothing was drawn into the framebuffer, keep the last render
 
     framebuffer.write_tga_file("framebuffer.tga");
     return 0;
@@ -3,6 +3,8 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
+#include <utility>
 
 // Constructor - loads the OBJ file
 Model::Model(const std::string& filename) {
@@ -47,9 +49,37 @@ Model::Model(const std::string& filename) {
     }
 
     file.close();
+
+    // Collect the sides of every triangle once, neighbouring triangles share sides
+    // so a wireframe drawn from the faces directly would draw most lines twice
+    std::vector<std::pair<int, int>> sides;
+    sides.reserve(faces.size());
+    int dropped = 0;
+    for (int i = 0; i < nfaces(); i++) {
+        for (int j = 0; j < 3; j++) {
+            int a = faces[i * 3 + j], b = faces[i * 3 + (j + 1) % 3];
+            if (a < 0 || a >= nverts() || b < 0 || b >= nverts()) { // edge() hands out indices without further checks
+                dropped++;
+                continue;
+            }
+            sides.push_back(std::minmax(a, b)); // order the indices so both orientations of a side compare equal
+        }
+    }
+    if (dropped) {
+        std::cerr << "Dropped " << dropped << " edges with out of bounds vertex indices" << std::endl;
+    }
+    std::sort(sides.begin(), sides.end());
+    sides.erase(std::unique(sides.begin(), sides.end()), sides.end());
+    edges.reserve(sides.size() * 2);
+    for (const auto& [a, b] : sides) {
+        edges.push_back(a);
+        edges.push_back(b);
+    }
+
     std::cout << "Loaded " << filename << ": "
         << vertices.size() << " vertices, "
-        << faces.size() << " faces" << std::endl;
+        << nfaces() << " faces, "
+        << nedges() << " edges" << std::endl;
 }
 
 // Destructor
@@ -64,7 +94,12 @@ int Model::nverts() const {
 
 // Return number of faces
 int Model::nfaces() const {
-    return faces.size();
+    return faces.size() / 3;
+}
+
+// Return number of unique edges
+int Model::nedges() const {
+    return edges.size() / 2;
 }
 
 // Return vertex at index i
@@ -89,4 +124,14 @@ vec3 Model::vert(const int iface, const int nthvert) const {
         return vec3();
     }
     return vertices[face_index];
+}
+
+// Return the vertex index of the nth end of edge iedge
+int Model::edge(const int iedge, const int nthvert) const {
+    int index = iedge * 2 + nthvert;
+    if (index < 0 || index >= static_cast<int>(edges.size())) {
+        std::cerr << "Index out of bounds in Model::edge()" << std::endl;
+        return 0;
+    }
+    return edges[index];
 }
\ No newline at end of file
@@ -4,11 +4,14 @@
 class Model {
     std::vector<vec3> vertices = {}; // array of vertices
     std::vector<int> faces = {}; // triangles defined by vertex indices every 3 indices is a face 0-2, 3-5, ...
+    std::vector<int> edges = {}; // unique triangle sides defined by vertex indices every 2 indices is an edge 0-1, 2-3, ...
 public:
     Model(const std::string& filename);
     ~Model();
     int nverts() const; // number of vertices
     int nfaces() const; // number of triangles
+    int nedges() const; // number of unique edges, a side shared by several triangles is counted once
     vec3 vert(const int i) const; // 0 <= i < nverts()
     vec3 vert(const int iface, const int nthvert) const; // 0 <= iface <= nfaces(), 0 <= nthvert < 3
+    int edge(const int iedge, const int nthvert) const; // vertex index, 0 <= iedge < nedges(), 0 <= nthvert < 2
 };
\ No newline at end of file
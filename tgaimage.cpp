@@ -208,3 +208,11 @@ int TGAImage::height() const {
     return h;
 }
 
+int TGAImage::bytespp() const {
+    return bpp;
+}
+
+std::uint8_t* TGAImage::buffer() {
+    return data.data();
+}
+
@@ -39,6 +39,8 @@ struct TGAImage {
     void set(const int x, const int y, const TGAColor& c);
     int width()  const;
     int height() const;
+    int bytespp() const;
+    std::uint8_t* buffer(); // raw pixel rows, (x + y*width())*bytespp() is the offset of pixel {x,y}
 private:
     bool   load_rle_data(std::ifstream& in);
     bool unload_rle_data(std::ofstream& out) const;